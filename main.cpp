@@ -1,4 +1,12 @@
+#include <algorithm>
 #include <array>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
 
 #include "p8s/MetricCollector.h"
 #include "p8s/Client.h"
@@ -273,12 +281,572 @@ void testClient()
     client.close();
 }
 
+bool testAsyncLogger()
+{
+    bool isPassed = true;
+    auto fnCheck = [&isPassed](bool condition, const char* message)
+        {
+            printf("[%s] %s \n", (condition == true) ? "PASS" : "FAIL", message);
+            isPassed &= condition;
+        };
+
+    std::mutex lock;
+    std::vector<std::string> logs;
+    auto fnCount = [&lock, &logs](const std::string& log)
+        {
+            std::lock_guard grab(lock);
+            return std::count(logs.begin(), logs.end(), log);
+        };
+
+    {
+        p8s::LogOption option;
+        option.maxPerSecond_ = 4;
+
+        p8s::detail::AsyncLogger logger([&lock, &logs](std::string&& log)
+            {
+                std::lock_guard grab(lock);
+                logs.emplace_back(std::move(log));
+            }, option);
+
+        // Ʈ  αװ   Ȳ
+        for (int i = 0; i < 50; ++i)
+        {
+            logger.push("Skip push(endpoint: A)");
+            logger.push("Skip push(endpoint: B)");
+        }
+
+        //  αװ ص ٸ α״ ӵ ѿ ɸ ʾƾ Ѵ.
+        for (int i = 0; i < 500; ++i)
+            logger.push("flood");
+        logger.push("unrelated");
+    }
+
+    fnCheck(fnCount("Skip push(endpoint: A)") == 1, "interleaved logs are emitted once");
+    fnCheck(fnCount("Skip push(endpoint: A) (repeated 49 times)") == 1, "interleaved repeats are summarized per message");
+    fnCheck(fnCount("Skip push(endpoint: B) (repeated 49 times)") == 1, "interleaved repeats are summarized per message");
+    fnCheck(fnCount("unrelated") == 1, "flooding message does not use up the rate limit");
+    fnCheck(fnCount("flood (repeated 499 times)") == 1, "flooding message is summarized");
+
+    return isPassed;
+}
+
+/// <summary>
+/// pushgateway   HTTP 
+/// pushgateway ó PUT   йи ° ٲٰ, POST   ̸ йи ٲ۴.
+/// </summary>
+class StubGateway : public CivetHandler
+{
+public:
+    explicit StubGateway(uint16_t port)
+        : server_({ "listening_ports", std::to_string(port), "num_threads", "2" })
+    {
+        server_.addHandler("/metrics", this);
+    }
+
+    bool handlePut(CivetServer*, struct mg_connection* conn) override { return _handle(conn, true); }
+    bool handlePost(CivetServer*, struct mg_connection* conn) override { return _handle(conn, false); }
+
+    std::set<std::string> getFamilies() const
+    {
+        std::scoped_lock grab(lock_);
+        return setFamily_;
+    }
+
+    std::optional<double> getValue(const std::string& family) const
+    {
+        std::scoped_lock grab(lock_);
+        auto findIter = mapValue_.find(family);
+        if (findIter == mapValue_.end())
+            return std::nullopt;
+
+        return findIter->second;
+    }
+
+    void clear()
+    {
+        std::scoped_lock grab(lock_);
+        setFamily_.clear();
+        mapValue_.clear();
+    }
+
+protected:
+    bool _handle(struct mg_connection* conn, bool isReplace)
+    {
+        std::istringstream body(CivetServer::getPostData(conn));
+
+        if (isReplace == true)
+            clear();
+
+        constexpr std::string_view typePrefix = "# TYPE ";
+        std::string line;
+        while (std::getline(body, line))
+        {
+            std::scoped_lock grab(lock_);
+            if (line.starts_with(typePrefix) == true)
+            {
+                setFamily_.emplace(line.substr(typePrefix.size(), line.find(' ', typePrefix.size()) - typePrefix.size()));
+                continue;
+            }
+
+            // name{labels} value
+            if ((line.empty() == true) || (line.front() == '#'))
+                continue;
+
+            mapValue_[line.substr(0, line.find_first_of("{ "))] = std::stod(line.substr(line.rfind(' ') + 1));
+        }
+
+        mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+        return true;
+    }
+
+protected:
+    mutable std::mutex lock_;
+    std::set<std::string> setFamily_;
+    std::map<std::string, double> mapValue_;   // family, last value
+    CivetServer server_;
+};
+
+bool testMultiGatewayClient()
+{
+    // 19091 ~ 19093   , 19094  ƹ  ʴ Ʈ
+    constexpr uint16_t basePort = 19091;
+    std::array<std::unique_ptr<StubGateway>, 3> stubs;
+    for (size_t i = 0; i < stubs.size(); ++i)
+        stubs[i] = std::make_unique<StubGateway>(static_cast<uint16_t>(basePort + i));
+
+    bool isPassed = true;
+    auto fnCheck = [&isPassed](bool condition, const char* message)
+        {
+            printf("[%s] %s \n", (condition == true) ? "PASS" : "FAIL", message);
+            isPassed &= condition;
+        };
+
+    p8s::Client client(
+        [](std::string&& str)
+        {
+            printf("%s \n", str.c_str());
+        }
+    );
+
+    const std::array<std::string, 6> familyNames{ "shard_a", "shard_b", "shard_c", "shard_d", "shard_e", "shard_f" };
+    for (uint32_t i = 0; i < familyNames.size(); ++i)
+    {
+        client
+            .registerFamily(familyNames[i], "multi gateway test")
+            .addGauge(i, { {"index", std::to_string(i)} })
+            ;
+    }
+
+    p8s::ClientOption option
+    {
+        .jobName_ = "sample_multi_client",
+        .mapLabel_ = { {"instance", "sample_multi_client"} },
+        .timeout_ = std::chrono::seconds(1),
+        .flushInterval_ = std::chrono::seconds(1),
+        .endpoints_ =
+        {
+            { .ipAddress_ = "127.0.0.1", .port_ = basePort + 0 },
+            { .ipAddress_ = "127.0.0.1", .port_ = basePort + 1 },
+            { .ipAddress_ = "127.0.0.1", .port_ = basePort + 2 },
+            { .ipAddress_ = "127.0.0.1", .port_ = basePort + 3 },
+        },
+        .shardPolicy_ = p8s::eShardPolicy::FamilyHash,
+    };
+
+    //    Ʈ    .
+    {
+        const p8s::ClientOption credential
+        {
+            .userName_ = "user",
+            .password_ = "password",
+            .endpoints_ = { { .ipAddress_ = "127.0.0.1" }, { .ipAddress_ = "127.0.0.1", .userName_ = "own", .password_ = "own" } },
+        };
+
+        const std::vector<p8s::GatewayEndpoint> endpoints = credential.getEndpoints();
+        fnCheck((endpoints[0].userName_ == "user") && (endpoints[0].password_ == "password")
+            && (endpoints[1].userName_ == "own") && (endpoints[1].password_ == "own"), "endpoint credentials fall back to option credentials");
+    }
+
+    //  Ʈ̰  ־  ޵ǹǷ  Ѵ.
+    fnCheck(client.open(std::move(option)) == true, "open with one unreachable endpoint");
+
+    auto fnCollect = [&stubs]()
+        {
+            std::map<std::string, std::vector<size_t>> mapOwner;    // family, stub index
+            for (size_t i = 0; i < stubs.size(); ++i)
+            {
+                if (stubs[i] == nullptr)
+                    continue;
+
+                for (const std::string& name : stubs[i]->getFamilies())
+                    mapOwner[name].emplace_back(i);
+            }
+            return mapOwner;
+        };
+
+    auto fnIsAllDelivered = [&familyNames](const std::map<std::string, std::vector<size_t>>& mapOwner)
+        {
+            return std::all_of(familyNames.begin(), familyNames.end(),
+                [&mapOwner](const std::string& name) { return mapOwner.contains(name); });
+        };
+
+    //  Ʈ   flush ȿ push  ޾ Ʈ̷ Ѿ.
+    {
+        const auto mapOwner = fnCollect();
+        for (const auto& [name, owners] : mapOwner)
+        {
+            for (const size_t owner : owners)
+                printf("%s -> %u \n", name.c_str(), static_cast<uint32_t>(basePort + owner));
+        }
+
+        fnCheck(fnIsAllDelivered(mapOwner), "every family reached a live stub in the first flush");
+    }
+
+    // backoff   ڿ  йи  Ʈ̷ .
+    std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+    fnCheck(fnIsAllDelivered(fnCollect()), "every family reached a live stub");
+
+    //  ִ  ϳ    Ѿ Ѵ.
+    stubs[1].reset();
+    for (auto& stub : stubs)
+    {
+        if (stub != nullptr)
+            stub->clear();
+    }
+
+    //    backoff ̶    flush ȿ ٸ  Ѿ.
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    fnCheck(fnIsAllDelivered(fnCollect()), "every family reached a live stub after one stub went down");
+
+    client.close();
+    return isPassed;
+}
+
+bool testSpool()
+{
+    const std::string spoolPath = "p8s_test.spool";
+    std::filesystem::remove(spoolPath);
+
+    bool isPassed = true;
+    auto fnCheck = [&isPassed](bool condition, const char* message)
+        {
+            printf("[%s] %s \n", (condition == true) ? "PASS" : "FAIL", message);
+            isPassed &= condition;
+        };
+
+    auto fnSnapshot = [](double value)
+        {
+            prometheus::ClientMetric metric;
+            metric.label.push_back({ "index", "0" });
+            metric.gauge.value = value;
+
+            prometheus::MetricFamily family;
+            family.name = "spool_gauge";
+            family.help = "spool test";
+            family.type = prometheus::MetricType::Gauge;
+            family.metric.push_back(metric);
+
+            return std::vector<prometheus::MetricFamily>{ family };
+        };
+
+    const p8s::SpoolOption spoolOption{ .path_ = spoolPath };
+
+    //    ϳ ´.
+    {
+        p8s::detail::Spool spool(spoolOption);
+        fnCheck(spool.empty() == true, "spool starts empty");
+        fnCheck(spool.save(fnSnapshot(1.0), 1000) == true, "save first snapshot");
+        fnCheck(spool.save(fnSnapshot(2.0), 2000) == true, "save second snapshot");
+    }
+    {
+        p8s::detail::Spool spool(spoolOption);
+
+        std::vector<prometheus::MetricFamily> families;
+        int64_t timestampMs = 0;
+        const bool isLoaded = spool.load(families, timestampMs);
+        fnCheck((isLoaded == true) && (timestampMs == 2000) && (families.size() == 1)
+            && (families[0].metric.size() == 1) && (families[0].metric[0].gauge.value == 2.0), "reopen and load latest snapshot");
+    }
+
+    // payload   crc ˻翡 ɷ Ѵ.
+    {
+        std::fstream file(spoolPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7F');
+    }
+    {
+        p8s::detail::Spool spool(spoolOption);
+
+        std::vector<prometheus::MetricFamily> families;
+        int64_t timestampMs = 0;
+        fnCheck(spool.load(families, timestampMs) == false, "reject corrupted snapshot");
+
+        spool.clear();
+        fnCheck(spool.empty() == true, "clear spool");
+    }
+
+    //   μ   isRestore_     client   ȴ.
+    for (const bool isRestore : { false, true })
+    {
+        {
+            p8s::detail::Spool spool(spoolOption);
+            fnCheck(spool.save(fnSnapshot(42.0), 3000) == true, "save snapshot left by crashed process");
+        }
+
+        const uint16_t port = (isRestore == true) ? 19096 : 19095;
+        StubGateway stub(port);
+
+        p8s::Client client(
+            [](std::string&& str)
+            {
+                printf("%s \n", str.c_str());
+            }
+        );
+
+        client
+            .registerFamily("spool_gauge", "spool test")
+            .addGauge(0, { {"index", "0"} })
+            ;
+
+        p8s::ClientOption option
+        {
+            .jobName_ = "sample_spool_client",
+            .endpoints_ = { { .ipAddress_ = "127.0.0.1", .port_ = port } },
+            .spool_ = { .path_ = spoolPath, .isRestore_ = isRestore },
+        };
+
+        fnCheck(client.open(std::move(option)) == true, "open client with spool");
+        if (isRestore == true)
+            fnCheck(stub.getValue("spool_gauge") == 42.0, "restored value reached gateway");
+        else
+            fnCheck(stub.getValue("spool_gauge") == 0.0, "gauge is left untouched without isRestore_");
+        fnCheck(std::filesystem::exists(spoolPath) == false, "spool cleared after delivery");
+
+        client.close();
+    }
+
+    // Ʈ̰  ׾  ޵  йи Ǯ ´.
+    {
+        p8s::Client client;
+        client
+            .registerFamily("spool_gauge", "spool test")
+            .addGauge(0, { {"index", "0"} })
+            ;
+        client.increment(0, 5.0);
+
+        p8s::ClientOption option
+        {
+            .jobName_ = "sample_spool_client",
+            .endpoints_ = { { .ipAddress_ = "127.0.0.1", .port_ = 19097 } },
+            .spool_ = spoolOption,
+        };
+
+        fnCheck(client.open(std::move(option)) == false, "open fails when nothing was delivered");
+
+        p8s::detail::Spool spool(spoolOption);
+        std::vector<prometheus::MetricFamily> families;
+        int64_t timestampMs = 0;
+        const bool isLoaded = spool.load(families, timestampMs);
+        fnCheck((isLoaded == true) && (families.size() == 1) && (families[0].name == "spool_gauge")
+            && (families[0].metric.size() == 1) && (families[0].metric[0].gauge.value == 5.0), "undelivered family is spooled");
+
+        spool.clear();
+    }
+
+    // ޵  йи ״θ  ٽ  ʴ´.
+    {
+        p8s::detail::Spool spool(spoolOption);
+        fnCheck(spool.save(fnSnapshot(7.0), 4000) == true, "save snapshot");
+
+        const auto writeTime = std::filesystem::last_write_time(spoolPath);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        fnCheck((spool.save(fnSnapshot(7.0), 5000) == true) && (std::filesystem::last_write_time(spoolPath) == writeTime), "skip saving unchanged snapshot");
+        fnCheck((spool.save(fnSnapshot(8.0), 6000) == true) && (std::filesystem::last_write_time(spoolPath) != writeTime), "save changed snapshot");
+    }
+
+    std::filesystem::remove(spoolPath);
+    return isPassed;
+}
+
+/// <summary>
+///   Ʈ  Ȯϱ  ׽Ʈ 
+/// </summary>
+class InspectServer : public p8s::Server
+{
+public:
+    bool isValid() const { return isValid_; }
+
+    std::optional<double> getValue(const std::string& familyName, const p8s::detail::mapLabel_t& mapLabel) const
+    {
+        for (const prometheus::MetricFamily& family : registry_->Collect())
+        {
+            if (family.name != familyName)
+                continue;
+
+            for (const prometheus::ClientMetric& metric : family.metric)
+            {
+                p8s::detail::mapLabel_t labels;
+                for (const prometheus::ClientMetric::Label& label : metric.label)
+                    labels.emplace(label.name, label.value);
+
+                if (labels == mapLabel)
+                    return metric.gauge.value;
+            }
+        }
+
+        return std::nullopt;
+    }
+};
+
+bool testBulkRegister()
+{
+    bool isPassed = true;
+    auto fnCheck = [&isPassed](bool condition, const char* message)
+        {
+            printf("[%s] %s \n", (condition == true) ? "PASS" : "FAIL", message);
+            isPassed &= condition;
+        };
+
+    auto fnFamily = [](const std::string& name, uint32_t baseKey, uint32_t rowCount)
+        {
+            p8s::BulkFamily family{ .name_ = name, .help_ = "bulk test", .labelNames_ = { "shard", "slot" } };
+            family.labelColumns_.resize(family.labelNames_.size());
+
+            for (uint32_t row = 0; row < rowCount; ++row)
+            {
+                family.labelColumns_[0].emplace_back(std::to_string(row % 4));
+                family.labelColumns_[1].emplace_back(std::to_string(row));
+                family.keys_.emplace_back(baseKey + row);
+            }
+            return family;
+        };
+
+    std::vector<p8s::BulkFamily> families;
+    families.emplace_back(fnFamily("bulk_a", 0, 100));
+    families.emplace_back(fnFamily("bulk_b", 100, 100));
+    families.emplace_back(fnFamily("bulk_c", 200, 100));
+    families.emplace_back(fnFamily("bulk_bad", 300, 10));
+
+    // bulk_b     bulk_a  Ű ģ.
+    families[1].keys_[0] = 50;
+    families[1].keys_[1] = 51;
+
+    // bulk_bad    ̰ Ű  ٸ.
+    families[3].labelColumns_[1].pop_back();
+
+    InspectServer server;
+    const p8s::BulkResult result = server.registerBulk(families, 4);
+
+    std::vector<uint32_t> duplicateKeys = result.duplicateKeys_;
+    std::sort(duplicateKeys.begin(), duplicateKeys.end());
+
+    fnCheck(result.isAccepted_ == true, "bulk registration is accepted");
+    fnCheck(duplicateKeys == std::vector<uint32_t>{ 50, 51 }, "duplicate keys are reported");
+    fnCheck(result.failedFamilies_ == std::vector<std::string>{ "bulk_bad" }, "family with mismatched columns is reported");
+    fnCheck(result.gaugeCount_ == 298, "gauge count excludes duplicates and failed family");
+    fnCheck(result.isSuccess() == false, "result is not a full success");
+    fnCheck(server.isValid() == true, "collector stays valid");
+
+    // Ű   ° Ǿ Ѵ.
+    server.increment(0, 3.0);
+    server.increment(150, 2.0);
+    server.increment(299, 1.0);
+    server.increment(50, 7.0);
+    fnCheck(server.getValue("bulk_a", { {"shard", "0"}, {"slot", "0"} }) == 3.0, "increment reaches bulk_a row 0");
+    fnCheck(server.getValue("bulk_b", { {"shard", "2"}, {"slot", "50"} }) == 2.0, "increment reaches bulk_b row 50");
+    fnCheck(server.getValue("bulk_c", { {"shard", "3"}, {"slot", "99"} }) == 1.0, "increment reaches bulk_c row 99");
+    fnCheck((server.getValue("bulk_a", { {"shard", "2"}, {"slot", "50"} }) == 7.0)
+        && (server.getValue("bulk_b", { {"shard", "0"}, {"slot", "0"} }) == std::nullopt), "duplicate key keeps the first family's gauge");
+
+    // 뷮  ڿ    ״ ȴ.
+    server
+        .registerFamily("bulk_after", "bulk test")
+        .addGauge(1000, { {"slot", "0"} })
+        ;
+    server.increment(1000, 4.0);
+    fnCheck(server.getValue("bulk_after", { {"slot", "0"} }) == 4.0, "chained registration still works after bulk");
+
+    server.close();
+    return isPassed;
+}
+
+void benchmarkBulkRegister()
+{
+    // ۽ 뷮  ð  (30 йи * 10000 ø = 30)
+    constexpr uint32_t familyCount = 30;
+    constexpr uint32_t seriesCount = 10000;
+
+    std::vector<p8s::BulkFamily> families(familyCount);
+    for (uint32_t i = 0; i < familyCount; ++i)
+    {
+        p8s::BulkFamily& family = families[i];
+        family.name_ = std::format("bulk_family_{}", i);
+        family.help_ = "bulk registration benchmark";
+        family.labelNames_ = { "shard", "slot" };
+        family.labelColumns_.resize(family.labelNames_.size());
+
+        for (uint32_t j = 0; j < seriesCount; ++j)
+        {
+            family.labelColumns_[0].emplace_back(std::to_string(j % 16));
+            family.labelColumns_[1].emplace_back(std::to_string(j));
+            family.keys_.emplace_back(i * seriesCount + j);
+        }
+    }
+
+    auto fnMeasure = [](auto&& fnRegister)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            fnRegister();
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+        };
+
+    p8s::Server chained;
+    const auto chainedElapsed = fnMeasure([&chained, &families]()
+        {
+            for (const p8s::BulkFamily& family : families)
+            {
+                auto configurer = chained.registerFamily(family.name_, family.help_);
+                for (size_t row = 0; row < family.keys_.size(); ++row)
+                {
+                    configurer.addGauge(family.keys_[row],
+                        { { family.labelNames_[0], family.labelColumns_[0][row] }, { family.labelNames_[1], family.labelColumns_[1][row] } });
+                }
+            }
+        });
+
+    printf("hardwareConcurrency: %u, chained addGauge: %lld(ms) \n", std::thread::hardware_concurrency(), static_cast<long long>(chainedElapsed));
+    chained.close();
+
+    //   Ȯ强     ÷ .
+    const uint32_t maxThreadCount = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+    for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreadCount))
+    {
+        p8s::Server bulk;
+        p8s::BulkResult result;
+        const auto bulkElapsed = fnMeasure([&bulk, &families, &result, threadCount]() { result = bulk.registerBulk(families, threadCount); });
+
+        printf("registerBulk(threads: %u): %lld(ms), gauges: %zu, success: %d \n",
+            threadCount, static_cast<long long>(bulkElapsed), result.gaugeCount_, result.isSuccess());
+
+        bulk.close();
+        if (threadCount == maxThreadCount)
+            break;
+    }
+}
+
 int main()
 {
     // exampleServer();
     // exampleClient();
     // testClient();
-    testServer();
+    // benchmarkBulkRegister();
+    // testServer();
+
+    bool isPassed = true;
+    isPassed &= testAsyncLogger();
+    isPassed &= testMultiGatewayClient();
+    isPassed &= testSpool();
+    isPassed &= testBulkRegister();
 
-    return 0;
+    return (isPassed == true) ? 0 : 1;
 }
@@ -1,10 +1,20 @@
 #pragma once
 
 #include "MetricCollector.h"
-#include "prometheus/gateway.h"
+#include "GatewayWorker.h"
+#include "Spool.h"
 
 namespace p8s
 {
+    /// <summary>
+    /// Ʈ̰    йи  
+    /// </summary>
+    enum class eShardPolicy : uint8_t
+    {
+        FamilyHash,     // йи ̸ ؽ÷ Ʈ ϳ . (ֽ  Ʈ̷ ѱ.)
+        Replicate,      //  Ʈ̿  ͸ .
+    };
+
     /// <summary>
     /// client   ɼ
     /// </summary>
@@ -12,22 +22,53 @@ namespace p8s
     {
         std::string toString() const
         {
-            return std::format("ip: {}, port: {}, jobName: {}, userName: {}, password: {}, timeout: {}(sec), flushInterval: {}(sec)",
-                ipAddress_, port_, jobName_, userName_, password_, timeout_.count(), flushInterval_.count());
+            std::string strEndpoints;
+            for (const GatewayEndpoint& endpoint : getEndpoints())
+                strEndpoints.append(strEndpoints.empty() == true ? "" : ", ").append(endpoint.toString());
+
+            return std::format("endpoints: [{}], shardPolicy: {}, jobName: {}, userName: {}, password: {}, timeout: {}(sec), flushInterval: {}(sec), spool: {{ {} }}",
+                strEndpoints, (shardPolicy_ == eShardPolicy::FamilyHash) ? "FamilyHash" : "Replicate",
+                jobName_, userName_, password_, timeout_.count(), flushInterval_.count(), spool_.toString());
+        }
+
+        /// <summary>
+        /// endpoints_     Ʈ(ipAddress_, port_)  Ѵ.
+        ///  (userName_, password_)  Ʈ    ״ .
+        /// </summary>
+        std::vector<GatewayEndpoint> getEndpoints() const
+        {
+            if (endpoints_.empty() == true)
+                return { GatewayEndpoint{ ipAddress_, port_, userName_, password_ } };
+
+            std::vector<GatewayEndpoint> endpoints = endpoints_;
+            for (GatewayEndpoint& endpoint : endpoints)
+            {
+                if ((endpoint.userName_.empty() == true) && (endpoint.password_.empty() == true))
+                {
+                    endpoint.userName_ = userName_;
+                    endpoint.password_ = password_;
+                }
+            }
+            return endpoints;
         }
 
     public:
-        std::string ipAddress_;
+        std::string ipAddress_ = {};
         uint16_t port_ = 0;
 
-        std::string jobName_;
+        std::string jobName_ = {};
         detail::mapLabel_t mapLabel_ = {};
 
-        std::string userName_;
-        std::string password_;
+        std::string userName_ = {};
+        std::string password_ = {};
 
         std::chrono::seconds timeout_ = std::chrono::seconds(1);
         std::chrono::seconds flushInterval_ = std::chrono::seconds(1);
+
+        std::vector<GatewayEndpoint> endpoints_ = {};
+        eShardPolicy shardPolicy_ = eShardPolicy::FamilyHash;
+
+        SpoolOption spool_ = {};
     };
 }
 
@@ -39,11 +80,24 @@ namespace p8s
     /// </summary>
     class Client : public MetricCollector
     {
-        using fnFlush_t = std::function<void(prometheus::Gateway*)>;
+        using vecFamily_t = std::vector<prometheus::MetricFamily>;
+
+        /// <summary>
+        ///  йи Ʈ ϳ ̻ ޵Ǿ ޵  .
+        /// </summary>
+        struct PushResult
+        {
+            bool isDelivered() const { return (acceptedCount_ > 0) && (undeliveredCount_ == 0); }
+
+        public:
+            size_t familyCount_ = 0;
+            size_t acceptedCount_ = 0;      // push  ޾ Ʈ 
+            size_t undeliveredCount_ = 0;   //  Ʈ̿ ޵  йи 
+        };
 
     public:
-        Client(fnLog_t&& fnLog = nullptr)
-            : MetricCollector(std::move(fnLog))
+        Client(fnLog_t&& fnLog = nullptr, const LogOption& logOption = {})
+            : MetricCollector(std::move(fnLog), logOption)
         {}
 
     public:
@@ -51,12 +105,20 @@ namespace p8s
 
     protected:
         virtual void _close() override;
-        bool _flush() const;
+        bool _flush();
+        PushResult _push(vecFamily_t&& families, vecFamily_t* undelivered = nullptr);
+        std::vector<bool> _pushShards(vecFamily_t& families, const std::vector<std::vector<size_t>>& shards, const std::vector<bool>& targets, bool isAdd, bool isCopy, std::vector<bool>& delivered, std::vector<bool>& moved);
+        std::vector<std::vector<size_t>> _shard(const vecFamily_t& families, const std::vector<bool>& available) const;
+        void _restore();
+        void _spool(vecFamily_t&& undelivered);
         void _run();
 
     protected:
         ClientOption option_;
-        std::unique_ptr<prometheus::Gateway> gateway_ = nullptr;
+        std::vector<std::unique_ptr<detail::GatewayWorker>> workers_;
+
+        std::unique_ptr<detail::Spool> spool_ = nullptr;
+
         std::unique_ptr<std::thread> thread_;
         std::condition_variable cond_;
     };
@@ -1,10 +1,14 @@
 #include "Client.h"
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
 namespace p8s
 {
     bool Client::open(ClientOption&& option)
     {
-        if ((isClosed() == true) || (gateway_ != nullptr))
+        if ((isClosed() == true) || (workers_.empty() == false))
             throw std::runtime_error("Duplicate try open");
 
         if (isValid_ == false)
@@ -14,31 +18,40 @@ namespace p8s
 
         try
         {
-            gateway_ = std::make_unique<prometheus::Gateway>(
-                option_.ipAddress_,
-                std::to_string(option_.port_),
-                option_.jobName_,
-                option_.mapLabel_,
-                option_.userName_,
-                option_.password_,
-                option_.timeout_
-            );
+            for (const GatewayEndpoint& endpoint : option_.getEndpoints())
+            {
+                workers_.emplace_back(std::make_unique<detail::GatewayWorker>(
+                    endpoint,
+                    option_.jobName_,
+                    option_.mapLabel_,
+                    option_.timeout_
+                ));
+            }
         }
         catch (const CivetException& e)
         {
-            _log(f{ "Failed to open gateway(option: {}, error: {})", option_.toString(), e.what() });
+            _log(eLogLevel::Error, f{ "Failed to open gateway(option: {}, error: {})", option_.toString(), e.what() });
+            workers_.clear();
             return false;
         }
 
-        gateway_->RegisterCollectable(registry_);
+        if (option_.spool_.path_.empty() == false)
+        {
+            spool_ = std::make_unique<detail::Spool>(option_.spool_);
+
+            // ǻ츰   increment/decrement  Ƿ   쿡 Ѵ.
+            if (option_.spool_.isRestore_ == true)
+                _restore();
+        }
 
         // ý ѹ push   Ǵ  Ȯϰ Ѿ.
+        // Ʈ Ϻΰ ׾ ־  йи ٸ  Ѿ ޵Ǿ Ѵ.
         if (_flush() == false)
             return false;
 
         thread_ = std::make_unique<std::thread>([this]() { this->_run(); });
 
-        _log(f{ "Success to open gateway(option: {})", option_.toString() });
+        _log(eLogLevel::Info, f{ "Success to open gateway(option: {})", option_.toString() });
         return true;
     }
 
@@ -59,23 +72,232 @@ namespace p8s
         }
         _flush();
 
-        gateway_.reset();
+        workers_.clear();
+        spool_.reset();
         MetricCollector::close();
     }
 
-    bool Client::_flush() const
+    bool Client::_flush()
     {
-        if (gateway_ == nullptr)
+        if (workers_.empty() == true)
             throw std::runtime_error("Not opened");
 
-        const int status = gateway_->Push();
-        if (status != 200)
+        vecFamily_t undelivered;
+        const PushResult result = _push(registry_->Collect(), (spool_ != nullptr) ? &undelivered : nullptr);
+
+        if (result.acceptedCount_ == 0)
+            _log(eLogLevel::Error, f{ "Failed to push(endpoints: {}, error: no endpoint accepted)", workers_.size() });
+        else if (result.undeliveredCount_ > 0)
+            _log(eLogLevel::Error, f{ "Failed to deliver families(undelivered: {}, total: {})", result.undeliveredCount_, result.familyCount_ });
+
+        if (spool_ != nullptr)
+            _spool(std::move(undelivered));
+
+        return result.isDelivered();
+    }
+
+    auto Client::_push(vecFamily_t&& families, vecFamily_t* undelivered /*= nullptr*/) -> PushResult
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        std::vector<bool> available(workers_.size());
+        for (size_t i = 0; i < workers_.size(); ++i)
         {
-            _log(f{ "Failed to push(status: {})", status });
-            return false;
+            available[i] = workers_[i]->isAvailable(now);
+            if (available[i] == false)
+                _log(eLogLevel::Warn, f{ "Skip push(endpoint: {}, error: backoff)", workers_[i]->getEndpoint().toString() });
         }
 
-        return true;
+        //    ܵд.  к   ٽ Ѵ.
+        const bool isReplicate = (option_.shardPolicy_ == eShardPolicy::Replicate);
+
+        PushResult result;
+        result.familyCount_ = families.size();
+
+        // Ʈ̺  ÿ .
+        std::vector<bool> delivered(families.size(), false);
+        std::vector<bool> moved(families.size(), false);
+        const std::vector<bool> accepted = _pushShards(families, _shard(families, available), available, false, isReplicate, delivered, moved);
+        result.acceptedCount_ = static_cast<size_t>(std::count(accepted.begin(), accepted.end(), true));
+
+        if ((std::find(delivered.begin(), delivered.end(), false) == delivered.end())
+            || ((result.acceptedCount_ == 0) && (undelivered == nullptr)))
+        {
+            result.undeliveredCount_ = static_cast<size_t>(std::count(delivered.begin(), delivered.end(), false));
+            return result;
+        }
+
+        // ޵  йи . Ŀ Ѿ йи ̸  Ƿ  ͸ ٽ Ѵ.
+        vecFamily_t retry;
+        std::unordered_set<std::string> setMoved;
+        for (size_t index = 0; index < families.size(); ++index)
+        {
+            if (delivered[index] == true)
+                continue;
+
+            if (moved[index] == true)
+                setMoved.emplace(families[index].name);
+            else
+                retry.emplace_back(std::move(families[index]));
+        }
+
+        if (setMoved.empty() == false)
+        {
+            for (prometheus::MetricFamily& family : registry_->Collect())
+            {
+                if (setMoved.contains(family.name) == true)
+                    retry.emplace_back(std::move(family));
+            }
+        }
+
+        //  Ʈ  ̹ push  ޾ Ʈ̷ ѱ.
+        // Push(PUT)  grouping key  °    йи Ƿ PushAdd(POST)  δ.
+        // ٽ ϸ Ǯ ܾ ϹǷ ̶  ܵд.
+        std::vector<bool> retryDelivered(retry.size(), false);
+        if (result.acceptedCount_ > 0)
+        {
+            std::vector<bool> retryMoved(retry.size(), false);
+            _pushShards(retry, _shard(retry, accepted), accepted, true, (isReplicate == true) || (undelivered != nullptr), retryDelivered, retryMoved);
+        }
+
+        for (size_t index = 0; index < retry.size(); ++index)
+        {
+            if (retryDelivered[index] == true)
+                continue;
+
+            ++result.undeliveredCount_;
+            if (undelivered != nullptr)
+                undelivered->emplace_back(std::move(retry[index]));
+        }
+
+        return result;
+    }
+
+    std::vector<bool> Client::_pushShards(vecFamily_t& families, const std::vector<std::vector<size_t>>& shards, const std::vector<bool>& targets, bool isAdd, bool isCopy, std::vector<bool>& delivered, std::vector<bool>& moved)
+    {
+        std::vector<std::future<int>> results(workers_.size());
+        for (size_t i = 0; i < workers_.size(); ++i)
+        {
+            // PushAdd   û   . Push   ־  Ѱ йи ȴ.
+            if ((targets[i] == false) || ((isAdd == true) && (shards[i].empty() == true)))
+                continue;
+
+            vecFamily_t shard;
+            shard.reserve(shards[i].size());
+            for (const size_t index : shards[i])
+            {
+                prometheus::MetricFamily& family = families[index];
+                if (isCopy == true)
+                {
+                    shard.emplace_back(family);
+                    continue;
+                }
+
+                // н ٽ   ֵ ̸ ܵΰ ð迭 ѱ.
+                shard.emplace_back(prometheus::MetricFamily{ family.name, family.help, family.type, std::move(family.metric) });
+                moved[index] = true;
+            }
+
+            results[i] = workers_[i]->push(std::move(shard), isAdd);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+
+        std::vector<bool> accepted(workers_.size(), false);
+        for (size_t i = 0; i < workers_.size(); ++i)
+        {
+            if (results[i].valid() == false)
+                continue;
+
+            const int status = results[i].get();
+            workers_[i]->onResult(status == 200, now);
+
+            if (status != 200)
+            {
+                _log(eLogLevel::Warn, f{ "Failed to push(endpoint: {}, status: {})", workers_[i]->getEndpoint().toString(), status });
+                continue;
+            }
+
+            accepted[i] = true;
+            for (const size_t index : shards[i])
+                delivered[index] = true;
+        }
+
+        return accepted;
+    }
+
+    auto Client::_shard(const vecFamily_t& families, const std::vector<bool>& available) const -> std::vector<std::vector<size_t>>
+    {
+        const size_t workerCount = workers_.size();
+        std::vector<std::vector<size_t>> shards(workerCount);
+
+        if (option_.shardPolicy_ == eShardPolicy::Replicate)
+        {
+            for (size_t i = 0; i < workerCount; ++i)
+            {
+                if (available[i] == false)
+                    continue;
+
+                shards[i].resize(families.size());
+                std::iota(shards[i].begin(), shards[i].end(), size_t{ 0 });
+            }
+            return shards;
+        }
+
+        for (size_t familyIndex = 0; familyIndex < families.size(); ++familyIndex)
+        {
+            // μ ޶  Ʈ̷  std::hash  FNV-1a  .
+            uint64_t hash = 14695981039346656037ull;
+            for (const char ch : families[familyIndex].name)
+                hash = (hash ^ static_cast<uint8_t>(ch)) * 1099511628211ull;
+
+            //  Ʈ̰  ̸  Ʈ̷ ѱ.
+            // push  grouping key ü Ƿ   Ѱܹ޾Ҵ ʿ ڿ ȴ.
+            const size_t owner = static_cast<size_t>(hash % workerCount);
+            for (size_t probe = 0; probe < workerCount; ++probe)
+            {
+                const size_t index = (owner + probe) % workerCount;
+                if (available[index] == false)
+                    continue;
+
+                shards[index].emplace_back(familyIndex);
+                break;
+            }
+        }
+
+        return shards;
+    }
+
+    void Client::_restore()
+    {
+        vecFamily_t families;
+        int64_t timestampMs = 0;
+        if (spool_->load(families, timestampMs) == false)
+        {
+            if (spool_->empty() == false)
+                _log(eLogLevel::Warn, f{ "Failed to load spool(option: {}, error: corrupted)", option_.spool_.toString() });
+            return;
+        }
+
+        const size_t restoredCount = _restoreGauges(families);
+        _log(eLogLevel::Info, f{ "Success to restore spool(series: {}, savedAt: {}(ms))", restoredCount, timestampMs });
+    }
+
+    void Client::_spool(vecFamily_t&& undelivered)
+    {
+        //  ޵Ǿ  ° .
+        if (undelivered.empty() == true)
+        {
+            if (spool_->empty() == false)
+                spool_->clear();
+            return;
+        }
+
+        const int64_t timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        if (spool_->save(undelivered, timestampMs) == false)
+            _log(eLogLevel::Warn, f{ "Failed to save spool(option: {})", option_.spool_.toString() });
     }
 
     void Client::_run()
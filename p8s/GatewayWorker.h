@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "prometheus/collectable.h"
+#include "prometheus/gateway.h"
+#include "prometheus/metric_family.h"
+
+namespace p8s
+{
+    /// <summary>
+    /// Ǫ Ʈ  
+    /// </summary>
+    struct GatewayEndpoint
+    {
+        std::string toString() const
+        {
+            return std::format("{}:{}", ipAddress_, port_);
+        }
+
+    public:
+        std::string ipAddress_ = {};
+        uint16_t port_ = 0;
+
+        std::string userName_ = {};
+        std::string password_ = {};
+    };
+}
+
+namespace p8s::detail
+{
+    /// <summary>
+    /// push  Ѱܹ  ״  collectable
+    /// Ʈ Client    ϰ, Ʈ̺   ⿡ ä.
+    /// </summary>
+    class SnapshotCollectable : public prometheus::Collectable
+    {
+    public:
+        void set(std::vector<prometheus::MetricFamily>&& families) { families_ = std::move(families); }
+
+        // Gateway  push     ϹǷ  ʰ Ѱش.
+        std::vector<prometheus::MetricFamily> Collect() const override { return std::move(families_); }
+
+    protected:
+        mutable std::vector<prometheus::MetricFamily> families_;
+    };
+
+    /// <summary>
+    /// Ʈ ϳ ϴ push 
+    /// Gateway(curl ڵ)  Ͽ keep-alive  ϰ, Ʈ̺ ÿ push Ѵ.
+    ///  Ʈ̴  þ  ð  ܵȴ.
+    /// </summary>
+    class GatewayWorker
+    {
+    public:
+        GatewayWorker(const GatewayEndpoint& endpoint, const std::string& jobName, const std::map<std::string, std::string>& mapLabel, std::chrono::seconds timeout);
+        ~GatewayWorker();
+
+        GatewayWorker(const GatewayWorker&) = delete;
+        GatewayWorker& operator=(const GatewayWorker&) = delete;
+
+    public:
+        /// <summary>
+        /// isAdd  true ̸ grouping key  °  ʰ  ̸ йи üѴ. (PushAdd)
+        /// </summary>
+        [[nodiscard]] std::future<int> push(std::vector<prometheus::MetricFamily>&& families, bool isAdd = false);
+
+        bool isAvailable(std::chrono::steady_clock::time_point now) const { return now >= retryTime_; }
+        void onResult(bool success, std::chrono::steady_clock::time_point now);
+
+        const GatewayEndpoint& getEndpoint() const { return endpoint_; }
+
+    protected:
+        struct Request
+        {
+            std::vector<prometheus::MetricFamily> families_;
+            bool isAdd_ = false;
+        };
+
+        void _run();
+
+    protected:
+        static constexpr std::chrono::seconds maxBackoff_ = std::chrono::seconds(60);
+
+        GatewayEndpoint endpoint_;
+        std::shared_ptr<SnapshotCollectable> collectable_ = std::make_shared<SnapshotCollectable>();
+        std::unique_ptr<prometheus::Gateway> gateway_ = nullptr;
+
+        uint32_t failureCount_ = 0;
+        std::chrono::steady_clock::time_point retryTime_;
+
+        std::mutex lock_;
+        std::condition_variable cond_;
+        std::optional<Request> request_;
+        std::promise<int> result_;
+
+        std::stop_source cancellationSource_;
+        std::unique_ptr<std::thread> thread_;
+    };
+}
+
+#include "GatewayWorker.hpp"
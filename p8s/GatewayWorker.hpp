@@ -0,0 +1,92 @@
+#include "GatewayWorker.h"
+
+#include <algorithm>
+
+namespace p8s::detail
+{
+    GatewayWorker::GatewayWorker(const GatewayEndpoint& endpoint, const std::string& jobName, const std::map<std::string, std::string>& mapLabel, std::chrono::seconds timeout)
+        : endpoint_(endpoint)
+    {
+        gateway_ = std::make_unique<prometheus::Gateway>(
+            endpoint_.ipAddress_,
+            std::to_string(endpoint_.port_),
+            jobName,
+            mapLabel,
+            endpoint_.userName_,
+            endpoint_.password_,
+            timeout
+        );
+
+        gateway_->RegisterCollectable(collectable_);
+
+        thread_ = std::make_unique<std::thread>([this]() { this->_run(); });
+    }
+
+    GatewayWorker::~GatewayWorker()
+    {
+        {
+            std::scoped_lock grab(lock_);
+            cancellationSource_.request_stop();
+        }
+        cond_.notify_all();
+
+        if (thread_->joinable() == true)
+            thread_->join();
+        thread_.reset();
+    }
+
+    std::future<int> GatewayWorker::push(std::vector<prometheus::MetricFamily>&& families, bool isAdd /*= false*/)
+    {
+        std::future<int> future;
+        {
+            std::scoped_lock grab(lock_);
+            if (request_.has_value() == true)
+                throw std::runtime_error("Duplicate push request");
+
+            result_ = {};
+            future = result_.get_future();
+            request_ = Request{ std::move(families), isAdd };
+        }
+        cond_.notify_one();
+
+        return future;
+    }
+
+    void GatewayWorker::onResult(bool success, std::chrono::steady_clock::time_point now)
+    {
+        if (success == true)
+        {
+            failureCount_ = 0;
+            retryTime_ = {};
+            return;
+        }
+
+        const uint32_t shift = std::min<uint32_t>(failureCount_++, 6);
+        retryTime_ = now + std::min<std::chrono::seconds>(std::chrono::seconds(1ll << shift), maxBackoff_);
+    }
+
+    void GatewayWorker::_run()
+    {
+        std::stop_token token = cancellationSource_.get_token();
+
+        while (true)
+        {
+            Request request;
+            std::promise<int> result;
+            {
+                std::unique_lock grab(lock_);
+                cond_.wait(grab, [this, &token]() { return (request_.has_value() == true) || (token.stop_requested() == true); });
+
+                if (request_.has_value() == false)
+                    return;
+
+                request = std::move(*request_);
+                result = std::move(result_);
+                request_.reset();
+            }
+
+            collectable_->set(std::move(request.families_));
+            result.set_value((request.isAdd_ == true) ? gateway_->PushAdd() : gateway_->Push());
+        }
+    }
+}
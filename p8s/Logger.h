@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace p8s
+{
+    enum class eLogLevel : uint8_t
+    {
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Off,
+    };
+
+    /// <summary>
+    /// 񵿱 ΰ  ɼ
+    /// </summary>
+    struct LogOption
+    {
+        eLogLevel level_ = eLogLevel::Info;
+
+        size_t queueCapacity_ = 1024;                                               // 2 ŵ ø
+        size_t maxPerSecond_ = 100;                                                 // ߺ   ʴ ִ   (0 ̸ )
+        std::chrono::milliseconds dedupWindow_ = std::chrono::seconds(10);          //  α  
+        size_t dedupCapacity_ = 64;                                                 //      ٸ α 
+        std::chrono::milliseconds drainInterval_ = std::chrono::milliseconds(10);
+    };
+}
+
+namespace p8s::detail
+{
+    /// <summary>
+    /// α׸ ȣ 忡  ݹ  ʰ lock-free  ۿ 縸 Ѵ.
+    /// ׶ 尡      ߺ α׸ ,
+    ///  α׿ ӵ  ɾ    .
+    /// </summary>
+    class AsyncLogger
+    {
+    public:
+        using fnLog_t = std::function<void(std::string&&)>;
+
+    public:
+        AsyncLogger(fnLog_t&& fnLog, const LogOption& option);
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    public:
+        /// <summary>
+        ///   ȣϿ  θ ǴѴ. (ũ , )
+        /// ӵ  ߺ  ڿ ɾ ϹǷ Һ 忡 Ѵ.
+        /// </summary>
+        [[nodiscard]] bool acquire(eLogLevel level);
+
+        /// <summary>
+        /// ť    ʰ .
+        /// </summary>
+        void push(std::string&& log);
+
+        void setLevel(eLogLevel level) { level_.store(level, std::memory_order_relaxed); }
+        eLogLevel getLevel() const { return level_.load(std::memory_order_relaxed); }
+
+    protected:
+        struct Slot
+        {
+            std::atomic<size_t> sequence_ = 0;
+            std::string log_;
+        };
+
+        struct Repeat
+        {
+            size_t count_ = 0;
+            std::chrono::steady_clock::time_point firstTime_;
+        };
+
+        bool _pop(std::string& log);
+        void _drain();
+        void _emit(std::string&& log);
+        bool _acquireRate(std::chrono::steady_clock::time_point now);
+        void _flushRepeat(bool isForce);
+        void _flushDropped();
+        void _run();
+
+    protected:
+        fnLog_t fnLog_ = nullptr;
+        LogOption option_;
+        std::atomic<eLogLevel> level_ = eLogLevel::Info;
+
+        // Vyukov bounded queue ( ,  Һ)
+        std::unique_ptr<Slot[]> slots_;
+        size_t mask_ = 0;
+        alignas(64) std::atomic<size_t> enqueuePos_ = 0;
+        alignas(64) size_t dequeuePos_ = 0;
+
+        alignas(64) std::atomic<size_t> droppedByQueue_ = 0;
+
+        // ӵ  (Һ  )
+        std::chrono::steady_clock::time_point rateWindow_;
+        size_t rateCount_ = 0;
+        size_t droppedByRate_ = 0;
+
+        // ߺ  (Һ  )
+        std::unordered_map<std::string, Repeat> mapRepeat_;
+        std::chrono::steady_clock::time_point lastDroppedTime_;
+
+        std::stop_source cancellationSource_;
+        std::unique_ptr<std::thread> thread_;
+        std::condition_variable cond_;
+    };
+}
+
+#include "Logger.hpp"
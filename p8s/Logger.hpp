@@ -0,0 +1,203 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <format>
+#include <utility>
+
+namespace p8s::detail
+{
+    AsyncLogger::AsyncLogger(fnLog_t&& fnLog, const LogOption& option)
+        : fnLog_(std::move(fnLog))
+        , option_(option)
+        , level_(option.level_)
+    {
+        if (fnLog_ == nullptr)
+            return;
+
+        const size_t capacity = std::bit_ceil(std::max<size_t>(option_.queueCapacity_, 2));
+        slots_ = std::make_unique<Slot[]>(capacity);
+        mask_ = capacity - 1;
+
+        for (size_t i = 0; i < capacity; ++i)
+            slots_[i].sequence_.store(i, std::memory_order_relaxed);
+
+        thread_ = std::make_unique<std::thread>([this]() { this->_run(); });
+    }
+
+    AsyncLogger::~AsyncLogger()
+    {
+        if (thread_ == nullptr)
+            return;
+
+        cancellationSource_.request_stop();
+        cond_.notify_all();
+        if (thread_->joinable() == true)
+            thread_->join();
+        thread_.reset();
+
+        //    αױ .
+        _drain();
+        _flushRepeat(true);
+        _flushDropped();
+    }
+
+    bool AsyncLogger::acquire(eLogLevel level)
+    {
+        return (fnLog_ != nullptr) && (level >= getLevel());
+    }
+
+    void AsyncLogger::push(std::string&& log)
+    {
+        if (slots_ == nullptr)
+            return;
+
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+
+            const size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) == true)
+                    break;
+            }
+            else if (diff < 0)
+            {
+                droppedByQueue_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->log_ = std::move(log);
+        slot->sequence_.store(pos + 1, std::memory_order_release);
+    }
+
+    bool AsyncLogger::_pop(std::string& log)
+    {
+        Slot& slot = slots_[dequeuePos_ & mask_];
+        if (slot.sequence_.load(std::memory_order_acquire) != dequeuePos_ + 1)
+            return false;
+
+        log = std::move(slot.log_);
+        slot.log_.clear();
+        slot.sequence_.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    void AsyncLogger::_drain()
+    {
+        //  αװ   ʴ     .
+        _flushRepeat(false);
+
+        std::string log;
+        while (_pop(log) == true)
+            _emit(std::move(log));
+    }
+
+    void AsyncLogger::_emit(std::string&& log)
+    {
+        //   ȿ ̹  α״ ̿ ٸ αװ   .
+        auto iter = mapRepeat_.find(log);
+        if (iter != mapRepeat_.end())
+        {
+            ++iter->second.count_;
+            return;
+        }
+
+        // ߺ ɷ ڿ ӵ  ɾ  αװ ص ٸ α   ʰ Ѵ.
+        const auto now = std::chrono::steady_clock::now();
+        if (_acquireRate(now) == false)
+        {
+            ++droppedByRate_;
+            return;
+        }
+
+        //  ڸ    ״ ´.
+        if ((option_.dedupWindow_.count() > 0) && (mapRepeat_.size() < option_.dedupCapacity_))
+            mapRepeat_.emplace(log, Repeat{ 0, now });
+
+        fnLog_(std::move(log));
+    }
+
+    bool AsyncLogger::_acquireRate(std::chrono::steady_clock::time_point now)
+    {
+        if (option_.maxPerSecond_ == 0)
+            return true;
+
+        if (now - rateWindow_ >= std::chrono::seconds(1))
+        {
+            rateWindow_ = now;
+            rateCount_ = 0;
+        }
+
+        if (rateCount_ >= option_.maxPerSecond_)
+            return false;
+
+        ++rateCount_;
+        return true;
+    }
+
+    void AsyncLogger::_flushRepeat(bool isForce)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        for (auto iter = mapRepeat_.begin(); iter != mapRepeat_.end();)
+        {
+            const Repeat& repeat = iter->second;
+            if ((isForce == false) && (now - repeat.firstTime_ < option_.dedupWindow_))
+            {
+                ++iter;
+                continue;
+            }
+
+            if (repeat.count_ > 0)
+                fnLog_(std::format("{} (repeated {} times)", iter->first, repeat.count_));
+
+            iter = mapRepeat_.erase(iter);
+        }
+    }
+
+    void AsyncLogger::_flushDropped()
+    {
+        const size_t byRate = std::exchange(droppedByRate_, 0);
+        const size_t byQueue = droppedByQueue_.exchange(0, std::memory_order_relaxed);
+        if ((byRate == 0) && (byQueue == 0))
+            return;
+
+        fnLog_(std::format("[ logger ] Dropped logs(rateLimit: {}, queueFull: {})", byRate, byQueue));
+    }
+
+    void AsyncLogger::_run()
+    {
+        std::mutex lock;
+        std::stop_token token = cancellationSource_.get_token();
+
+        while (token.stop_requested() == false)
+        {
+            _drain();
+
+            //  α   θ   ü  ʰ Ѵ.
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastDroppedTime_ >= std::chrono::seconds(1))
+            {
+                _flushDropped();
+                lastDroppedTime_ = now;
+            }
+
+            {
+                std::unique_lock grab(lock);
+                cond_.wait_for(grab, option_.drainInterval_);
+            }
+        }
+    }
+}
@@ -7,17 +7,54 @@
 #include <format>
 #include <source_location>
 #include <functional>
+#include <string>
+#include <vector>
+#include <tuple>
 
 #include "prometheus/counter.h"
 #include "prometheus/registry.h"
 #include "CivetServer.h"
 
+#include "Logger.h"
+
 // ̺귯 ̹ prometheus   ־ εϰ p8s  ̹..
 namespace p8s::detail
 {
     using mapLabel_t = std::map<std::string, std::string>;	// key, value
 }
 
+namespace p8s
+{
+    /// <summary>
+    /// 뷮 Ͽ йи  ( )
+    /// labelColumns_[i][row]  labelNames_[i]  ̸,   ̴ keys_  ƾ Ѵ.
+    /// </summary>
+    struct BulkFamily
+    {
+        std::string name_ = {};
+        std::string help_ = {};
+
+        std::vector<std::string> labelNames_ = {};
+        std::vector<std::vector<std::string>> labelColumns_ = {};
+        std::vector<uint32_t> keys_ = {};
+    };
+
+    /// <summary>
+    /// 뷮  
+    /// ߺ Ű  йи ־  ϵǸ, isValid_   ʴ´.
+    /// </summary>
+    struct BulkResult
+    {
+        bool isSuccess() const { return (isAccepted_ == true) && (duplicateKeys_.empty() == true) && (failedFamilies_.empty() == true); }
+
+    public:
+        bool isAccepted_ = false;
+        size_t gaugeCount_ = 0;
+        std::vector<uint32_t> duplicateKeys_;
+        std::vector<std::string> failedFamilies_;
+    };
+}
+
 namespace p8s
 {
     /// <summary>
@@ -26,24 +63,39 @@ namespace p8s
     class MetricCollector
     {
     protected:
+        /// <summary>
+        /// ڸ θ  ΰ,   release()  Ѵ.
+        /// _log  full-expression ȿ ǹǷ   ʴ´.
+        /// </summary>
         template<typename ...TArgs>
         struct f
         {
             f(std::string_view format, TArgs&&... args, const std::source_location& location = std::source_location::current())
-                : log_(std::format("[ {}({}) ] ", location.function_name(), location.line())
-                    .append(std::vformat(format, std::make_format_args(args...))))
+                : format_(format)
+                , args_(std::forward<TArgs>(args)...)
+                , location_(location)
             {}
 
-            std::string release() { return std::move(log_); }
+            std::string release()
+            {
+                return std::apply([this](auto&... args)
+                    {
+                        return std::format("[ {}({}) ] ", location_.function_name(), location_.line())
+                            .append(std::vformat(format_, std::make_format_args(args...)));
+                    }, args_);
+            }
 
         protected:
-            std::string log_;
+            std::string_view format_;
+            std::tuple<TArgs...> args_;
+            std::source_location location_;
         };
 
         template<typename ...TArgs>
         f(std::string_view, TArgs&&...) -> f<TArgs...>;
 
         using mapGauge_t = std::unordered_map<uint32_t, prometheus::Gauge*>;
+        using mapFamily_t = std::unordered_map<std::string, prometheus::Family<prometheus::Gauge>*>;
 
         using fnLog_t = std::function<void(std::string&&)>;
         using fnModify_t = std::function<void(prometheus::Gauge*)>;
@@ -51,8 +103,8 @@ namespace p8s
         class FamilyConfigurer;
 
     protected:
-        explicit MetricCollector(fnLog_t&& fnLog)
-            : fnLog_(std::move(fnLog))
+        explicit MetricCollector(fnLog_t&& fnLog, const LogOption& logOption = {})
+            : logger_(std::move(fnLog), logOption)
         {}
         virtual ~MetricCollector() = default;
 
@@ -61,26 +113,31 @@ namespace p8s
         void close();
 
         [[nodiscard]] FamilyConfigurer registerFamily(const std::string& name, const std::string& help = {});
+        [[nodiscard]] BulkResult registerBulk(const std::vector<BulkFamily>& families, uint32_t threadCount = 0);
         void increment(uint32_t key, double value = 1.0);
         void decrement(uint32_t key, double value = 1.0);
         void change(uint32_t key, double value);
         void reset(uint32_t key);
 
+        void setLogLevel(eLogLevel level) { logger_.setLevel(level); }
+
     protected:
         virtual void _close() = 0;
 
         void _modifyGauge(uint32_t counterKey, fnModify_t&& fnModify) const;
         void _onAddGauge(uint32_t counterKey, prometheus::Gauge* gauge);
+        size_t _restoreGauges(const std::vector<prometheus::MetricFamily>& families);
 
         template<typename ...TArgs>
-        void _log(f<TArgs...>&& strLog) const;
+        void _log(eLogLevel level, f<TArgs...>&& strLog) const;
 
     protected:
         bool isValid_ = true;
         std::stop_source cancellationSource_;
 
-        fnLog_t fnLog_ = nullptr;
+        mutable detail::AsyncLogger logger_;
         mapGauge_t mapGauge_;
+        mapFamily_t mapFamily_;
         std::shared_ptr<prometheus::Registry> registry_ = std::make_shared<prometheus::Registry>();
     };
 }
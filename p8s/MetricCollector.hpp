@@ -1,5 +1,10 @@
 #include "MetricCollector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
 namespace p8s
 {
     void MetricCollector::close()
@@ -10,6 +15,7 @@ namespace p8s
         _close();
 
         mapGauge_.clear();
+        mapFamily_.clear();
         registry_.reset();
     }
 
@@ -25,19 +31,187 @@ namespace p8s
                 .Help(help)
                 .Register(*registry_);
 
-            _log(f{ "Success to register family(name: {})", name });
+            mapFamily_.emplace(name, &family);
+            _log(eLogLevel::Info, f{ "Success to register family(name: {})", name });
 
             return FamilyConfigurer{ this, &family };
         }
         catch (const CivetException& e)
         {
-            _log(f{ "Failed to register family(name: {}, error: {})", name, e.what() });
+            _log(eLogLevel::Error, f{ "Failed to register family(name: {}, error: {})", name, e.what() });
             isValid_ = false;
 
             return {};
         }
     }
 
+    auto MetricCollector::registerBulk(const std::vector<BulkFamily>& families, uint32_t threadCount /*= 0*/) -> BulkResult
+    {
+        BulkResult result;
+        if ((isValid_ == false) || (isClosed() == true))
+            return result;
+
+        result.isAccepted_ = true;
+
+        struct Job
+        {
+            const BulkFamily* desc_ = nullptr;
+            prometheus::Family<prometheus::Gauge>* family_ = nullptr;
+            std::vector<prometheus::Gauge**> slots_;    // row  mapGauge_  ġ (ߺ̸ nullptr)
+            std::string error_;
+        };
+
+        size_t totalCount = 0;
+        for (const BulkFamily& desc : families)
+            totalCount += desc.keys_.size();
+
+        mapGauge_.reserve(mapGauge_.size() + totalCount);
+
+        // Ʈ ϰ Ű ߺ ˻    óѴ.
+        std::vector<Job> jobs;
+        jobs.reserve(families.size());
+
+        for (const BulkFamily& desc : families)
+        {
+            const bool isShapeValid = (desc.labelColumns_.size() == desc.labelNames_.size())
+                && std::all_of(desc.labelColumns_.begin(), desc.labelColumns_.end(),
+                    [&desc](const auto& column) { return column.size() == desc.keys_.size(); });
+
+            if (isShapeValid == false)
+            {
+                _log(eLogLevel::Error, f{ "Failed to register family(name: {}, error: column size mismatch)", desc.name_ });
+                result.failedFamilies_.emplace_back(desc.name_);
+                continue;
+            }
+
+            Job& job = jobs.emplace_back();
+            job.desc_ = &desc;
+
+            try
+            {
+                job.family_ = &prometheus::BuildGauge()
+                    .Name(desc.name_)
+                    .Help(desc.help_)
+                    .Register(*registry_);
+            }
+            catch (const std::exception& e)
+            {
+                _log(eLogLevel::Error, f{ "Failed to register family(name: {}, error: {})", desc.name_, e.what() });
+                result.failedFamilies_.emplace_back(desc.name_);
+                jobs.pop_back();
+                continue;
+            }
+
+            mapFamily_.emplace(desc.name_, job.family_);
+
+            job.slots_.resize(desc.keys_.size(), nullptr);
+            for (size_t row = 0; row < desc.keys_.size(); ++row)
+            {
+                auto [iter, isInserted] = mapGauge_.try_emplace(desc.keys_[row], nullptr);
+                if (isInserted == false)
+                {
+                    result.duplicateKeys_.emplace_back(desc.keys_[row]);
+                    continue;
+                }
+
+                // unordered_map   ּҴ rehash  ȴ.
+                job.slots_[row] = &iter->second;
+            }
+        }
+
+        // Family::Add  йи  Ƿ йи  ķ ä.
+        auto fnBuild = [](Job& job)
+            {
+                const BulkFamily& desc = *job.desc_;
+
+                //       ٲ .
+                detail::mapLabel_t mapLabel;
+                std::vector<std::string*> values;
+                values.reserve(desc.labelNames_.size());
+                for (const std::string& labelName : desc.labelNames_)
+                    values.emplace_back(&mapLabel[labelName]);
+
+                try
+                {
+                    for (size_t row = 0; row < desc.keys_.size(); ++row)
+                    {
+                        if (job.slots_[row] == nullptr)
+                            continue;
+
+                        for (size_t column = 0; column < values.size(); ++column)
+                            *values[column] = desc.labelColumns_[column][row];
+
+                        *job.slots_[row] = &job.family_->Add(mapLabel);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    job.error_ = e.what();
+                }
+            };
+
+        const size_t hardwareCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        const size_t workerCount = std::min<size_t>((threadCount == 0) ? hardwareCount : threadCount, jobs.size());
+
+        std::atomic<size_t> nextJob = 0;
+        auto fnDrain = [&jobs, &nextJob, &fnBuild]()
+            {
+                for (size_t index = nextJob++; index < jobs.size(); index = nextJob++)
+                    fnBuild(jobs[index]);
+            };
+
+        // ȣ 嵵 ۾  Ƿ ϳ  .
+        std::vector<std::thread> workers;
+        workers.reserve((workerCount > 1) ? (workerCount - 1) : 0);
+
+        try
+        {
+            for (size_t i = 1; i < workerCount; ++i)
+                workers.emplace_back(fnDrain);
+        }
+        catch (const std::system_error& e)
+        {
+            _log(eLogLevel::Warn, f{ "Failed to spawn bulk worker(started: {}, error: {})", workers.size(), e.what() });
+        }
+
+        // 带   ߾  ۾ ⼭  óϰ,   ݵ join Ѵ.
+        fnDrain();
+        for (std::thread& worker : workers)
+            worker.join();
+
+        // ߿  йи ä  Ű ǵ.
+        for (Job& job : jobs)
+        {
+            for (size_t row = 0; row < job.slots_.size(); ++row)
+            {
+                if (job.slots_[row] == nullptr)
+                    continue;
+
+                if (*job.slots_[row] == nullptr)
+                    mapGauge_.erase(job.desc_->keys_[row]);
+                else
+                    ++result.gaugeCount_;
+            }
+
+            if (job.error_.empty() == false)
+            {
+                _log(eLogLevel::Error, f{ "Failed to add counter(family: {}, error: {})", job.desc_->name_, job.error_ });
+                result.failedFamilies_.emplace_back(job.desc_->name_);
+            }
+        }
+
+        if (result.duplicateKeys_.empty() == false)
+        {
+            _log(eLogLevel::Error, f{ "Failed to add counter(count: {}, firstKey: {}, error: already exist)",
+                result.duplicateKeys_.size(), result.duplicateKeys_.front() });
+        }
+
+        _log(eLogLevel::Info, f{ "Success to register bulk(families: {}, gauges: {}, duplicates: {}, failed: {}, threads: {})",
+            jobs.size(), result.gaugeCount_, result.duplicateKeys_.size(), result.failedFamilies_.size(), workers.size() + 1 });
+
+        return result;
+    }
+
     void MetricCollector::increment(uint32_t key, double value /*= 1.0*/)
     {
         _modifyGauge(key, [value](auto gauge) { gauge->Increment(value); });
@@ -82,20 +256,49 @@ namespace p8s
         if (mapGauge_.find(key) != mapGauge_.end())
         {
             isValid_ = false;
-            _log(f{ "Failed to add counter(key: {}, error: already exist)", key });
+            _log(eLogLevel::Error, f{ "Failed to add counter(key: {}, error: already exist)", key });
             return;
         }
 
         mapGauge_.emplace(key, gauge);
     }
 
+    size_t MetricCollector::_restoreGauges(const std::vector<prometheus::MetricFamily>& families)
+    {
+        size_t restoredCount = 0;
+
+        for (const prometheus::MetricFamily& family : families)
+        {
+            auto findIter = mapFamily_.find(family.name);
+            if ((findIter == mapFamily_.end()) || (family.type != prometheus::MetricType::Gauge))
+                continue;
+
+            for (const prometheus::ClientMetric& metric : family.metric)
+            {
+                detail::mapLabel_t mapLabel;
+                for (const prometheus::ClientMetric::Label& label : metric.label)
+                    mapLabel.emplace(label.name, label.value);
+
+                //  ٲ   ø   ʴ´.
+                if (findIter->second->Has(mapLabel) == false)
+                    continue;
+
+                findIter->second->Add(mapLabel).Set(metric.gauge.value);
+                ++restoredCount;
+            }
+        }
+
+        return restoredCount;
+    }
+
     template<typename ...TArgs>
-    inline void MetricCollector::_log(f<TArgs...>&& strLog) const
+    inline void MetricCollector::_log(eLogLevel level, f<TArgs...>&& strLog) const
     {
-        if (fnLog_ == nullptr)
+        //   α״  뵵 ġ ʴ´.
+        if (logger_.acquire(level) == false)
             return;
 
-        fnLog_(strLog.release());
+        logger_.push(strLog.release());
     }
 }
 
@@ -13,8 +13,8 @@ namespace p8s
     class Server : public MetricCollector
     {
     public:
-        Server(fnLog_t&& fnLog = nullptr)
-            : MetricCollector(std::move(fnLog))
+        Server(fnLog_t&& fnLog = nullptr, const LogOption& logOption = {})
+            : MetricCollector(std::move(fnLog), logOption)
         {}
 
     public:
@@ -16,13 +16,13 @@ namespace p8s
         }
         catch (const CivetException& e)
         {
-            _log(f{ "Failed to open exposer(host: {}, error: {})", host, e.what() });
+            _log(eLogLevel::Error, f{ "Failed to open exposer(host: {}, error: {})", host, e.what() });
             return false;
         }
 
         exposer_->RegisterCollectable(registry_);
 
-        _log(f{ "Success to open exposer(host: {}, threadCount: {})", host, threadCount });
+        _log(eLogLevel::Info, f{ "Success to open exposer(host: {}, threadCount: {})", host, threadCount });
         return true;
     }
 
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "prometheus/metric_family.h"
+
+namespace p8s
+{
+    /// <summary>
+    ///    ¸  Ǯ  ɼ
+    /// path_    Ǯ  ʴ´.
+    /// </summary>
+    struct SpoolOption
+    {
+        std::string toString() const
+        {
+            return std::format("path: {}, isRestore: {}", path_, isRestore_);
+        }
+
+    public:
+        std::string path_ = {};
+
+        // ۽    ǻ츰.
+        // ǻ츰   increment/decrement  Ƿ  ü   Ѿ Ѵ.
+        bool isRestore_ = false;
+    };
+}
+
+namespace p8s::detail
+{
+    /// <summary>
+    /// Ʈ̿   йи   ϳ Ϸ Ѵ.
+    /// pushgateway  grouping key     ְ     Ƿ
+    ///   ޿  .   μ  ¸ ϴ  . (SpoolOption::isRestore_)
+    ///  [magic(4)][version(4)][length(4)][crc32(4)][payload] ̴.
+    /// </summary>
+    class Spool
+    {
+        using vecFamily_t = std::vector<prometheus::MetricFamily>;
+
+    public:
+        explicit Spool(const SpoolOption& option);
+
+    public:
+        bool empty() const { return isEmpty_; }
+
+        /// <summary>
+        ///   üѴ. ӽ  ũ   ̸ ٲٹǷ ߰ ׾   ´.
+        ///     ٽ  ʴ´.
+        /// </summary>
+        [[nodiscard]] bool save(const vecFamily_t& families, int64_t timestampMs);
+
+        /// <summary>
+        ///  ų crc    false  ȯѴ.
+        /// </summary>
+        [[nodiscard]] bool load(vecFamily_t& families, int64_t& timestampMs) const;
+        void clear();
+
+    protected:
+        struct Header
+        {
+            uint32_t magic_;
+            uint32_t version_;
+            uint32_t length_;
+            uint32_t crc_;
+        };
+
+        static constexpr uint32_t magic_ = 0x50533850;     // "P8SP"
+        static constexpr uint32_t version_ = 2;
+
+        static void _encode(std::string& out, const vecFamily_t& families, int64_t timestampMs);
+        static bool _decode(std::string_view in, vecFamily_t& families, int64_t& timestampMs);
+        static uint32_t _crc32(const void* data, size_t size);
+        static bool _writeFile(const std::string& path, const std::string& data);
+        static bool _replaceFile(const std::string& from, const std::string& to);
+
+    protected:
+        SpoolOption option_;
+        bool isEmpty_ = true;
+        std::optional<uint32_t> savedCrc_ = std::nullopt;   //   йи ( ð ) crc
+    };
+}
+
+#include "Spool.hpp"
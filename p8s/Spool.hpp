@@ -0,0 +1,318 @@
+#include "Spool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif // _WIN32
+
+namespace p8s::detail
+{
+    Spool::Spool(const SpoolOption& option)
+        : option_(option)
+    {
+        std::error_code error;
+        isEmpty_ = (std::filesystem::exists(option_.path_, error) == false);
+    }
+
+    bool Spool::save(const vecFamily_t& families, int64_t timestampMs)
+    {
+        std::string data(sizeof(Header), '\0');
+        _encode(data, families, timestampMs);
+
+        //  ߿  flush  ҸǷ  ð    ٽ  ʴ´.
+        const size_t contentOffset = sizeof(Header) + sizeof(timestampMs);
+        const uint32_t contentCrc = _crc32(data.data() + contentOffset, data.size() - contentOffset);
+        if ((isEmpty_ == false) && (savedCrc_ == contentCrc))
+            return true;
+
+        const size_t payloadSize = data.size() - sizeof(Header);
+        const Header header{ magic_, version_, static_cast<uint32_t>(payloadSize), _crc32(data.data() + sizeof(Header), payloadSize) };
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        // ӽ Ͽ    üϹǷ ߿ ׾    ´.
+        const std::string tempPath = option_.path_ + ".tmp";
+        if ((_writeFile(tempPath, data) == false) || (_replaceFile(tempPath, option_.path_) == false))
+            return false;
+
+        isEmpty_ = false;
+        savedCrc_ = contentCrc;
+        return true;
+    }
+
+    bool Spool::load(vecFamily_t& families, int64_t& timestampMs) const
+    {
+        families.clear();
+        timestampMs = 0;
+
+        std::error_code error;
+        const uintmax_t fileSize = std::filesystem::file_size(option_.path_, error);
+        if ((error) || (fileSize < sizeof(Header)))
+            return false;
+
+        std::ifstream file(option_.path_, std::ios::binary);
+        if (file.is_open() == false)
+            return false;
+
+        Header header = {};
+        if ((file.read(reinterpret_cast<char*>(&header), sizeof(header)).good() == false)
+            || (header.magic_ != magic_)
+            || (header.version_ != version_)
+            || (sizeof(header) + header.length_ != fileSize))
+            return false;
+
+        std::string payload(header.length_, '\0');
+        if (file.read(payload.data(), static_cast<std::streamsize>(payload.size())).good() == false)
+            return false;
+
+        if ((_crc32(payload.data(), payload.size()) != header.crc_) || (_decode(payload, families, timestampMs) == false))
+        {
+            families.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Spool::clear()
+    {
+        std::error_code error;
+        std::filesystem::remove(option_.path_, error);
+        isEmpty_ = true;
+        savedCrc_.reset();
+    }
+
+    void Spool::_encode(std::string& out, const vecFamily_t& families, int64_t timestampMs)
+    {
+        auto putVarint = [&out](uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            };
+
+        auto putString = [&out, &putVarint](const std::string& value)
+            {
+                putVarint(value.size());
+                out.append(value);
+            };
+
+        auto putFixed = [&out](const auto& value)
+            {
+                out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            };
+
+        auto isSupported = [](prometheus::MetricType type)
+            {
+                return (type == prometheus::MetricType::Gauge)
+                    || (type == prometheus::MetricType::Counter)
+                    || (type == prometheus::MetricType::Untyped);
+            };
+
+        putFixed(timestampMs);
+        putVarint(std::count_if(families.begin(), families.end(), [&isSupported](const auto& family) { return isSupported(family.type); }));
+
+        for (const prometheus::MetricFamily& family : families)
+        {
+            if (isSupported(family.type) == false)
+                continue;
+
+            putString(family.name);
+            putString(family.help);
+            out.push_back(static_cast<char>(family.type));
+            putVarint(family.metric.size());
+
+            for (const prometheus::ClientMetric& metric : family.metric)
+            {
+                putVarint(metric.label.size());
+                for (const prometheus::ClientMetric::Label& label : metric.label)
+                {
+                    putString(label.name);
+                    putString(label.value);
+                }
+
+                const double value = (family.type == prometheus::MetricType::Gauge) ? metric.gauge.value
+                    : (family.type == prometheus::MetricType::Counter) ? metric.counter.value
+                    : metric.untyped.value;
+                putFixed(value);
+            }
+        }
+    }
+
+    bool Spool::_decode(std::string_view in, vecFamily_t& families, int64_t& timestampMs)
+    {
+        size_t position = 0;
+
+        auto getVarint = [&in, &position](uint64_t& value)
+            {
+                value = 0;
+                for (uint32_t shift = 0; (position < in.size()) && (shift < 64); shift += 7)
+                {
+                    const uint8_t byte = static_cast<uint8_t>(in[position++]);
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return true;
+                }
+                return false;
+            };
+
+        auto getString = [&in, &position, &getVarint](std::string& value)
+            {
+                uint64_t size = 0;
+                if ((getVarint(size) == false) || (size > in.size() - position))
+                    return false;
+
+                value.assign(in.substr(position, static_cast<size_t>(size)));
+                position += static_cast<size_t>(size);
+                return true;
+            };
+
+        auto getFixed = [&in, &position](auto& value)
+            {
+                if (sizeof(value) > in.size() - position)
+                    return false;
+
+                std::memcpy(&value, in.data() + position, sizeof(value));
+                position += sizeof(value);
+                return true;
+            };
+
+        uint64_t familyCount = 0;
+        if ((getFixed(timestampMs) == false) || (getVarint(familyCount) == false))
+            return false;
+
+        for (uint64_t i = 0; i < familyCount; ++i)
+        {
+            prometheus::MetricFamily& family = families.emplace_back();
+
+            uint8_t type = 0;
+            uint64_t metricCount = 0;
+            if ((getString(family.name) == false) || (getString(family.help) == false)
+                || (getFixed(type) == false) || (getVarint(metricCount) == false))
+                return false;
+
+            family.type = static_cast<prometheus::MetricType>(type);
+
+            for (uint64_t j = 0; j < metricCount; ++j)
+            {
+                prometheus::ClientMetric& metric = family.metric.emplace_back();
+
+                uint64_t labelCount = 0;
+                if (getVarint(labelCount) == false)
+                    return false;
+
+                for (uint64_t k = 0; k < labelCount; ++k)
+                {
+                    prometheus::ClientMetric::Label& label = metric.label.emplace_back();
+                    if ((getString(label.name) == false) || (getString(label.value) == false))
+                        return false;
+                }
+
+                double value = 0.0;
+                if (getFixed(value) == false)
+                    return false;
+
+                switch (family.type)
+                {
+                case prometheus::MetricType::Gauge: metric.gauge.value = value; break;
+                case prometheus::MetricType::Counter: metric.counter.value = value; break;
+                default: metric.untyped.value = value; break;
+                }
+            }
+        }
+
+        return position == in.size();
+    }
+
+    uint32_t Spool::_crc32(const void* data, size_t size)
+    {
+        static constexpr std::array<uint32_t, 256> table = []()
+            {
+                std::array<uint32_t, 256> table = {};
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+                    table[i] = crc;
+                }
+                return table;
+            }();
+
+        uint32_t crc = 0xFFFFFFFFu;
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    bool Spool::_writeFile(const std::string& path, const std::string& data)
+    {
+        // μ ƴ϶ ȣƮ ׾  ũ .
+#ifdef _WIN32
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        DWORD written = 0;
+        const bool isSuccess = (::WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) == TRUE)
+            && (written == data.size())
+            && (::FlushFileBuffers(file) == TRUE);
+
+        ::CloseHandle(file);
+        return isSuccess;
+#else
+        const int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+            return false;
+
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            const ssize_t written = ::write(file, data.data() + offset, data.size() - offset);
+            if (written <= 0)
+                break;
+
+            offset += static_cast<size_t>(written);
+        }
+
+        const bool isSuccess = (offset == data.size()) && (::fsync(file) == 0);
+        ::close(file);
+        return isSuccess;
+#endif // _WIN32
+    }
+
+    bool Spool::_replaceFile(const std::string& from, const std::string& to)
+    {
+#ifdef _WIN32
+        return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == TRUE;
+#else
+        if (::rename(from.c_str(), to.c_str()) != 0)
+            return false;
+
+        // ̸ 浵 ͸ ׸  ȣƮ  ڿ ´.
+        const std::filesystem::path parent = std::filesystem::path(to).parent_path();
+        const int directory = ::open(parent.empty() == true ? "." : parent.c_str(), O_RDONLY);
+        if (directory < 0)
+            return true;
+
+        ::fsync(directory);
+        ::close(directory);
+        return true;
+#endif // _WIN32
+    }
+}